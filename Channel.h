@@ -0,0 +1,533 @@
+//
+//  Channel.h
+//
+//  Copyright (c) 2016 Olivier Cuisenaire. All rights reserved.
+//
+
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "LinkedList.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+class Executor;
+
+/// Coroutine lancée par un Executor, qui la détruit quand elle se termine
+
+class Task {
+public:
+
+   struct promise_type {
+
+      /**
+       *  @brief Fin de la coroutine : la rend à son Executor
+       */
+      struct FinalAwaiter {
+         bool await_ready() const noexcept {
+            return false;
+         }
+         void await_suspend(coroutine_handle<promise_type> h) noexcept;
+         void await_resume() const noexcept {
+         }
+      };
+
+      Task get_return_object() noexcept {
+         return Task(coroutine_handle<promise_type>::from_promise(*this));
+      }
+
+      suspend_always initial_suspend() const noexcept {
+         return {};
+      }
+
+      FinalAwaiter final_suspend() const noexcept {
+         return {};
+      }
+
+      void return_void() const noexcept {
+      }
+
+      void unhandled_exception() noexcept {
+         error = current_exception();
+      }
+
+      Executor* executor = nullptr;
+      exception_ptr error;
+   };
+
+   Task(Task&& other) noexcept : handle(exchange(other.handle, nullptr)) {
+   }
+
+   Task& operator=(Task&&) = delete;
+
+   /**
+    *  @brief destructeur, détruit la coroutine si elle n'a pas été lancée
+    */
+   ~Task() {
+      if (handle) {
+         handle.destroy();
+      }
+   }
+
+private:
+   friend class Executor;
+
+   explicit Task(coroutine_handle<promise_type> handle) noexcept : handle(handle) {
+   }
+
+   coroutine_handle<promise_type> handle;
+};
+
+/// Ordonnanceur de Task
+
+class Executor {
+public:
+   virtual ~Executor() = default;
+
+   /**
+    *  @brief Planification de la reprise d'une coroutine suspendue
+    */
+   virtual void schedule(coroutine_handle<> h) = 0;
+
+   /**
+    *  @brief Attente de la fin de toutes les tâches lancées
+    *
+    *  @exception la première exception sortie d'une tâche
+    */
+   virtual void run() = 0;
+
+   /**
+    *  @brief Lancement d'une tâche sur cet Executor
+    */
+   void spawn(Task task) {
+      coroutine_handle<Task::promise_type> h = exchange(task.handle, nullptr);
+      h.promise().executor = this;
+      {
+         lock_guard<mutex> guard(lock);
+         ++pending;
+      }
+      try {
+         schedule(h);
+      } catch (...) {
+         lock_guard<mutex> guard(lock);
+         --pending;
+         h.destroy();
+         throw;
+      }
+   }
+
+protected:
+   friend struct Task::promise_type::FinalAwaiter;
+
+   /**
+    *  @brief Destruction d'une tâche terminée, en gardant sa première
+    *  exception
+    */
+   void finished(coroutine_handle<Task::promise_type> h) noexcept {
+      exception_ptr taskError = h.promise().error;
+      h.destroy();
+      {
+         lock_guard<mutex> guard(lock);
+         if (taskError && !error) {
+            error = taskError;
+         }
+         --pending;
+      }
+      idle.notify_all();
+   }
+
+   /**
+    *  @brief Relance de la première exception sortie d'une tâche
+    */
+   void rethrowError() {
+      exception_ptr taskError;
+      {
+         lock_guard<mutex> guard(lock);
+         taskError = exchange(error, nullptr);
+      }
+      if (taskError) {
+         rethrow_exception(taskError);
+      }
+   }
+
+   mutex lock;
+   condition_variable idle;
+   size_t pending = 0;
+   exception_ptr error;
+};
+
+inline void Task::promise_type::FinalAwaiter::await_suspend(coroutine_handle<promise_type> h) noexcept {
+   h.promise().executor->finished(h);
+}
+
+/// Executor exécutant toutes ses tâches dans le thread qui appelle run()
+
+class InlineExecutor : public Executor {
+public:
+
+   void schedule(coroutine_handle<> h) override {
+      ready.push_back(h);
+   }
+
+   /**
+    *  @exception la première exception sortie d'une tâche, sinon
+    *  std::logic_error("InlineExecutor::run") si des tâches restent
+    *  suspendues sans rien à exécuter (interblocage)
+    */
+   void run() override {
+      while (!ready.empty()) {
+         coroutine_handle<> h = ready.front();
+         ready.pop_front();
+         h.resume();
+      }
+      rethrowError();
+      if (pending != 0) {
+         throw logic_error("InlineExecutor::run");
+      }
+   }
+
+private:
+   deque<coroutine_handle<>> ready;
+};
+
+/// Executor répartissant ses tâches sur un groupe de threads
+
+class ThreadPoolExecutor : public Executor {
+public:
+
+   explicit ThreadPoolExecutor(size_t nbThreads = max(thread::hardware_concurrency(), 1u))
+   : pool(nbThreads) {
+   }
+
+   void schedule(coroutine_handle<> h) override {
+      pool.submit([h] { h.resume(); });
+   }
+
+   /**
+    *  @remark bloque indéfiniment si des tâches s'attendent mutuellement.
+    */
+   void run() override {
+      {
+         unique_lock<mutex> guard(lock);
+         idle.wait(guard, [this] { return pending == 0; });
+      }
+      rethrowError();
+   }
+
+private:
+   ThreadPool pool;
+};
+
+/// Canal borné entre coroutines, dont les éléments en transit sont rangés
+/// dans une LinkedList. send suspend l'émetteur tant que le canal est plein,
+/// receive suspend le récepteur tant qu'il est vide. Les coroutines
+/// réveillées sont reprises par l'Executor du canal.
+///
+/// @remark le canal doit survivre aux coroutines qui l'attendent.
+
+template <typename T>
+class Channel {
+private:
+
+   struct Sender {
+      const T* value;
+      bool sent = false;
+      exception_ptr error;
+      coroutine_handle<> handle;
+   };
+
+   struct Receiver {
+      optional<T> item;
+      LinkedList<T>* batch = nullptr;
+      size_t max = 1;
+      size_t count = 0;
+      exception_ptr error;
+      coroutine_handle<> handle;
+   };
+
+public:
+
+   class SendAwaiter {
+   public:
+      bool await_ready() const noexcept {
+         return false;
+      }
+
+      bool await_suspend(coroutine_handle<> h) {
+         return channel.suspendSend(sender, h);
+      }
+
+      /**
+       *  @return false si le canal a été fermé avant l'envoi
+       *
+       *  @exception celle levée par la copie de la valeur dans le canal
+       */
+      bool await_resume() const {
+         if (sender.error) {
+            rethrow_exception(sender.error);
+         }
+         return sender.sent;
+      }
+
+   private:
+      friend class Channel;
+
+      SendAwaiter(Channel& channel, const T& value) : channel(channel) {
+         sender.value = &value;
+      }
+
+      Channel& channel;
+      Sender sender;
+   };
+
+   class ReceiveAwaiter {
+   public:
+      bool await_ready() const noexcept {
+         return false;
+      }
+
+      bool await_suspend(coroutine_handle<> h) {
+         return channel.suspendReceive(receiver, h);
+      }
+
+      /**
+       *  @return l'élément reçu, vide si le canal est fermé et vide
+       *
+       *  @exception celle levée en déplaçant l'élément hors du canal, qui
+       *  le garde alors
+       */
+      optional<T> await_resume() {
+         if (receiver.error) {
+            rethrow_exception(receiver.error);
+         }
+         return move(receiver.item);
+      }
+
+   private:
+      friend class Channel;
+
+      explicit ReceiveAwaiter(Channel& channel) : channel(channel) {
+      }
+
+      Channel& channel;
+      Receiver receiver;
+   };
+
+   class BatchAwaiter {
+   public:
+      bool await_ready() const noexcept {
+         return false;
+      }
+
+      bool await_suspend(coroutine_handle<> h) {
+         return channel.suspendReceive(receiver, h);
+      }
+
+      /**
+       *  @return le nombre d'éléments reçus, 0 si le canal est fermé et vide
+       */
+      size_t await_resume() const {
+         if (receiver.error) {
+            rethrow_exception(receiver.error);
+         }
+         return receiver.count;
+      }
+
+   private:
+      friend class Channel;
+
+      BatchAwaiter(Channel& channel, LinkedList<T>& batch, size_t max) : channel(channel) {
+         receiver.batch = &batch;
+         receiver.max = max;
+      }
+
+      Channel& channel;
+      Receiver receiver;
+   };
+
+   /**
+    *  @brief Constructeur
+    *
+    *  @param executor l'Executor qui reprend les coroutines réveillées
+    *  @param capacity nombre maximal d'éléments en transit
+    *
+    *  @exception std::invalid_argument("Channel::Channel") si capacity est nul
+    */
+   Channel(Executor& executor, size_t capacity) : executor(executor), capacity(capacity) {
+      if (capacity == 0) {
+         throw invalid_argument("Channel::Channel");
+      }
+   }
+
+   Channel(const Channel&) = delete;
+   Channel& operator=(const Channel&) = delete;
+
+   /**
+    *  @brief co_await send(value) : envoi d'une copie de value, en attendant
+    *  qu'il y ait de la place
+    */
+   SendAwaiter send(const T& value) {
+      return SendAwaiter(*this, value);
+   }
+
+   /**
+    *  @brief co_await receive() : réception d'un élément, en attendant
+    *  qu'il y en ait un
+    */
+   ReceiveAwaiter receive() {
+      return ReceiveAwaiter(*this);
+   }
+
+   /**
+    *  @brief co_await receive_batch(batch, max) : réception d'au plus max
+    *  éléments disponibles, déplacés sans copie en fin de batch
+    *
+    *  @exception std::invalid_argument("Channel::receive_batch") si max est nul
+    */
+   BatchAwaiter receive_batch(LinkedList<T>& batch, size_t max) {
+      if (max == 0) {
+         throw invalid_argument("Channel::receive_batch");
+      }
+      return BatchAwaiter(*this, batch, max);
+   }
+
+   /**
+    *  @brief Fermeture du canal : les envois échouent, les réceptions
+    *  vident le canal puis échouent
+    */
+   void close() {
+      vector<coroutine_handle<>> woken;
+      {
+         lock_guard<mutex> guard(lock);
+         closed = true;
+         for (Sender* s : senders) {
+            woken.push_back(s->handle);
+         }
+         for (Receiver* r : receivers) {
+            woken.push_back(r->handle);
+         }
+         senders.clear();
+         receivers.clear();
+      }
+      wake(woken);
+   }
+
+   /**
+    *  @brief nombre d'éléments en transit
+    */
+   size_t size() const {
+      lock_guard<mutex> guard(lock);
+      return items.size();
+   }
+
+private:
+
+   bool suspendSend(Sender& s, coroutine_handle<> h) {
+      vector<coroutine_handle<>> woken;
+      {
+         lock_guard<mutex> guard(lock);
+         if (closed) {
+            return false;
+         }
+         if (items.size() == capacity) {
+            s.handle = h;
+            senders.push_back(&s);
+            return true;
+         }
+         woken.reserve(1 + min(senders.size(), receivers.empty() ? 0 : receivers.front()->max));
+         items.push_back(*s.value);
+         s.sent = true;
+         if (!receivers.empty()) {
+            Receiver* r = receivers.front();
+            take(*r, woken);
+            receivers.pop_front();
+            woken.push_back(r->handle);
+         }
+      }
+      wake(woken);
+      return false;
+   }
+
+   bool suspendReceive(Receiver& r, coroutine_handle<> h) {
+      vector<coroutine_handle<>> woken;
+      {
+         lock_guard<mutex> guard(lock);
+         if (items.size() == 0) {
+            if (closed) {
+               return false;
+            }
+            r.handle = h;
+            receivers.push_back(&r);
+            return true;
+         }
+         woken.reserve(min(senders.size(), r.max));
+         take(r, woken);
+      }
+      wake(woken);
+      return false;
+   }
+
+   /**
+    *  @brief Remise d'éléments à r, puis admission des émetteurs en attente
+    *  dans la place libérée. Appelée sous lock, woken ayant la place de
+    *  recevoir les émetteurs admis.
+    *
+    *  Une exception levée en déplaçant un élément vers r, ou en copiant la
+    *  valeur d'un émetteur, est rangée dans r ou l'émetteur pour être
+    *  relancée par son await_resume : r et l'émetteur sont tout de même
+    *  réveillés, et le canal garde ses éléments.
+    */
+   void take(Receiver& r, vector<coroutine_handle<>>& woken) noexcept {
+      try {
+         if (r.batch != nullptr) {
+            r.count = min(r.max, items.size());
+            r.batch->splice_back(items, r.count);
+         } else {
+            r.item.emplace(move(items.front()));
+            items.pop_front();
+            r.count = 1;
+         }
+      } catch (...) {
+         r.error = current_exception();
+         return;
+      }
+      while (items.size() < capacity && !senders.empty()) {
+         Sender* s = senders.front();
+         try {
+            items.push_back(*s->value);
+            s->sent = true;
+         } catch (...) {
+            s->error = current_exception();
+         }
+         woken.push_back(s->handle);
+         senders.pop_front();
+      }
+   }
+
+   void wake(const vector<coroutine_handle<>>& woken) {
+      for (coroutine_handle<> h : woken) {
+         executor.schedule(h);
+      }
+   }
+
+   Executor& executor;
+   const size_t capacity;
+   LinkedList<T> items;
+   deque<Sender*> senders;
+   deque<Receiver*> receivers;
+   bool closed = false;
+   mutable mutex lock;
+};
+
+#endif /* CHANNEL_H */
@@ -0,0 +1,1571 @@
+//
+//  LinkedList.h
+//
+//  Copyright (c) 2016 Olivier Cuisenaire. All rights reserved.
+//
+
+#ifndef LINKEDLIST_H
+#define LINKEDLIST_H
+
+#include <iostream>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+/// Politiques d'exécution des algorithmes de parcours de LinkedList
+namespace policy {
+   struct sequenced_policy {};
+   struct parallel_policy {};
+
+   constexpr sequenced_policy seq{};
+   constexpr parallel_policy par{};
+}
+
+/// Forward declaration classe
+template < typename T, bool CompactLinks = false > class LinkedList;
+
+/// Forward declaration fonction d'affichage
+template <typename T, bool CompactLinks>
+ostream& operator<<(ostream& os, const LinkedList<T, CompactLinks>& liste);
+
+/// Classe de liste chainee
+///
+/// Avec CompactLinks, les maillons sont rangés dans une table partagée par
+/// les listes compactes de T et chaînés par des indices de 32 bits au lieu
+/// de pointeurs.
+
+template < typename T, bool CompactLinks > class LinkedList {
+   friend ostream& operator<< <T, CompactLinks>(ostream& os, const LinkedList<T, CompactLinks>& liste);
+   //friend class Int;
+public:
+   using value_type = T;
+   using reference = T&;
+   using const_reference = const T&;
+   using pointer = T*;
+   using const_pointer = const T*;
+
+private:
+
+   struct Node;
+   class NodeIndex;
+   class NodeTable;
+
+   /**
+    *  @brief Lien vers un maillon : pointeur, ou indice dans NodeTable
+    *  pour les listes compactes
+    */
+   using NodePtr = conditional_t<CompactLinks, NodeIndex, Node*>;
+
+   /**
+    *  @brief Type du marqueur de suppression différée rangé dans les
+    *  maillons à liens pointeurs. Les maillons compacts n'en ont pas : leur
+    *  marqueur est le bit de poids fort de leur lien next.
+    */
+   struct NoFlag {
+   };
+   using DeadFlag = conditional_t<CompactLinks, NoFlag, bool>;
+
+   /**
+    *  @brief Maillon de la chaine.
+    * 
+    * contient une valeur, un marqueur de suppression différée et le lien
+    * vers le maillon suivant. Pour T = int, un maillon occupe 16 octets
+    * avec des liens pointeurs et 8 octets avec des liens compacts.
+    */
+   struct Node {
+      value_type data;
+      [[no_unique_address]] DeadFlag dead;
+      NodePtr next;
+
+      Node(const_reference data, NodePtr next = nullptr)
+      : data(data), dead(), next(next) {
+         cout << "(C" << data << ") ";
+      }
+      Node(Node&) = delete;
+      Node(Node&&) = delete;
+
+      ~Node() {
+         cout << "(D" << data << ") ";
+      }
+
+      bool isDead() const noexcept {
+         if constexpr (CompactLinks) {
+            return next.marked();
+         } else {
+            return dead;
+         }
+      }
+
+      void markDead() noexcept {
+         if constexpr (CompactLinks) {
+            next.mark();
+         } else {
+            dead = true;
+         }
+      }
+   };
+
+   /**
+    *  @brief Lien compact : indice 31 bits d'un maillon dans NodeTable.
+    *
+    *  S'utilise comme un pointeur ; l'indice 0 représente nullptr. Le bit
+    *  de poids fort est le marqueur de suppression du maillon qui contient
+    *  le lien : il n'est pas copié avec l'indice, et l'affectation d'un
+    *  autre lien le conserve.
+    */
+   class NodeIndex {
+   public:
+      static constexpr uint32_t deadBit = uint32_t(1) << 31;
+
+      NodeIndex(nullptr_t = nullptr) noexcept : index(0) {
+      }
+
+      explicit NodeIndex(uint32_t index) noexcept : index(index) {
+      }
+
+      NodeIndex(const NodeIndex& other) noexcept : index(other.value()) {
+      }
+
+      NodeIndex& operator=(const NodeIndex& other) noexcept {
+         index = (index & deadBit) | other.value();
+         return *this;
+      }
+
+      Node* operator->() const noexcept {
+         return NodeTable::get(value());
+      }
+
+      explicit operator bool() const noexcept {
+         return value() != 0;
+      }
+
+      bool operator==(NodeIndex other) const noexcept {
+         return value() == other.value();
+      }
+
+      bool operator!=(NodeIndex other) const noexcept {
+         return value() != other.value();
+      }
+
+      uint32_t value() const noexcept {
+         return index & ~deadBit;
+      }
+
+      bool marked() const noexcept {
+         return (index & deadBit) != 0;
+      }
+
+      void mark() noexcept {
+         index |= deadBit;
+      }
+
+   private:
+      uint32_t index;
+   };
+
+   /**
+    *  @brief Table des maillons des listes compactes de value_type
+    *
+    *  Le maillon d'indice i >= 1 est rangé à la place i % blockSize du bloc
+    *  i / blockSize, les blocs de blockSize maillons étant alloués à la
+    *  demande. Les blocs ne sont jamais déplacés ni libérés : la mémoire
+    *  de la table ne diminue pas quand les listes rétrécissent, leurs
+    *  places libres sont seulement réutilisées.
+    *
+    *  Chaque thread garde ses places libres dans un cache local, qu'il
+    *  remplit et vide par lots de cacheBatch places sous un mutex commun
+    *  à toutes les listes de ce type. Le cache d'un thread est rendu à la
+    *  table quand il se termine.
+    */
+   class NodeTable {
+   public:
+      static constexpr unsigned blockBits = 16;
+      static constexpr uint32_t blockSize = uint32_t(1) << blockBits;
+
+      static Node* get(uint32_t index) noexcept {
+         return reinterpret_cast<Node*>(slot(index));
+      }
+
+      static NodeIndex create(const_reference value, NodeIndex next) {
+         uint32_t index = acquire();
+         try {
+            new (get(index)) Node{value, next};
+         } catch (...) {
+            release(index);
+            throw;
+         }
+         return NodeIndex(index);
+      }
+
+      static void destroy(NodeIndex n) noexcept {
+         n->~Node();
+         release(n.value());
+      }
+
+   private:
+      struct alignas(Node) Slot {
+         unsigned char bytes[sizeof(Node)];
+      };
+
+      static Slot* slot(uint32_t index) noexcept {
+         return blocks[index >> blockBits] + (index & (blockSize - 1));
+      }
+
+      /**
+       *  @brief Nombre de places échangées à la fois entre un cache local
+       *  et la table
+       */
+      static constexpr uint32_t cacheBatch = 64;
+
+      /**
+       *  @brief Liste chainée des places libres d'un thread, le lien étant
+       *  rangé dans la place elle-même
+       */
+      struct Cache {
+         uint32_t head = 0;
+         uint32_t size = 0;
+
+         void push(uint32_t index) noexcept {
+            memcpy(slot(index), &head, sizeof head);
+            head = index;
+            ++size;
+         }
+
+         uint32_t pop() noexcept {
+            uint32_t index = head;
+            memcpy(&head, slot(index), sizeof head);
+            --size;
+            return index;
+         }
+
+         ~Cache() {
+            lock_guard<mutex> guard(lock);
+            while (size != 0) {
+               uint32_t index = pop();
+               memcpy(slot(index), &freeHead, sizeof freeHead);
+               freeHead = index;
+            }
+         }
+      };
+
+      static uint32_t acquire() {
+         Cache& local = cache;
+         if (local.size == 0) {
+            refill(local);
+         }
+         return local.pop();
+      }
+
+      static void release(uint32_t index) noexcept {
+         Cache& local = cache;
+         local.push(index);
+         if (local.size >= 2 * cacheBatch) {
+            lock_guard<mutex> guard(lock);
+            for (uint32_t i = 0; i < cacheBatch; ++i) {
+               uint32_t freed = local.pop();
+               memcpy(slot(freed), &freeHead, sizeof freeHead);
+               freeHead = freed;
+            }
+         }
+      }
+
+      /**
+       *  @brief Transfert dans local d'au plus cacheBatch places, libérées
+       *  ou neuves
+       *
+       *  @exception std::bad_alloc si aucune place n'est disponible
+       */
+      static void refill(Cache& local) {
+         lock_guard<mutex> guard(lock);
+         while (local.size < cacheBatch && freeHead != 0) {
+            uint32_t index = freeHead;
+            memcpy(&freeHead, slot(index), sizeof freeHead);
+            local.push(index);
+         }
+         while (local.size < cacheBatch && nextIndex < NodeIndex::deadBit) {
+            Slot*& block = blocks[nextIndex >> blockBits];
+            if (block == nullptr) {
+               try {
+                  block = new Slot[blockSize];
+               } catch (...) {
+                  if (local.size != 0) {
+                     return;
+                  }
+                  throw;
+               }
+            }
+            local.push(nextIndex++);
+         }
+         if (local.size == 0) {
+            throw bad_alloc();
+         }
+      }
+
+      static inline Slot* blocks[NodeIndex::deadBit >> blockBits] = {};
+      static inline uint32_t nextIndex = 1;
+      static inline uint32_t freeHead = 0;
+      static inline mutex lock;
+      static inline thread_local Cache cache;
+   };
+
+   static NodePtr newNode(const_reference value, NodePtr next = nullptr) {
+      if constexpr (CompactLinks) {
+         return NodeTable::create(value, next);
+      } else {
+         return new Node{value, next};
+      }
+   }
+
+   static void deleteNode(NodePtr n) noexcept {
+      if constexpr (CompactLinks) {
+         NodeTable::destroy(n);
+      } else {
+         delete n;
+      }
+   }
+
+private:
+   /**
+    *  @brief  Tete de la LinkedList
+    */
+   NodePtr head;
+
+private:
+   /**
+    *  @brief  Dernier maillon de la chaine (eventuellement marqué supprimé)
+    */
+   NodePtr tail;
+
+private:
+   /**
+    *  @brief Nombre d'éléments
+    */
+   size_t nbElements;
+
+private:
+   /**
+    *  @brief Nombre de maillons marqués supprimés mais pas encore libérés
+    */
+   size_t nbDead;
+
+private:
+   /**
+    *  @brief Vrai si erase et erase_if ne font que marquer les maillons
+    */
+   bool lazyErase;
+
+private:
+   /**
+    *  @brief Dernier maillon accédé par position et sa position, pour que
+    *  les accès positionnels suivants à ou après lui partent de là.
+    *  nullptr si le curseur n'est pas valide.
+    *
+    *  @remark modifié par les méthodes const, qui ne peuvent donc pas être
+    *  appelées simultanément depuis plusieurs threads.
+    */
+   mutable NodePtr cursor;
+   mutable size_t cursorPos;
+   
+   public:
+
+   /**
+    *  @brief Constructeur par défaut. Construit une LinkedList vide
+    *
+    */
+   LinkedList() : nbElements(0), head(nullptr), tail(nullptr), nbDead(0), lazyErase(false),
+                  cursor(nullptr), cursorPos(0) {
+   }
+
+public:
+
+   /**
+    *  @brief Constructeur de copie
+    *
+    *  @param other la LinkedList à copier
+    */
+   LinkedList(LinkedList& other) : nbElements(0), head(nullptr), tail(nullptr), nbDead(0), lazyErase(false),
+                  cursor(nullptr), cursorPos(0) {
+      *this = other;
+   }
+
+public:
+
+   /**
+    *  @brief Opérateur d'affectation par copie
+    *
+    *  @param other la LinkedList à copier
+    *
+    *  @return la LinkedList courante *this (par référence)
+    *
+    *  @remark l'opérateur doit être une no-op si other 
+    *  est la LinkedList courante.
+    *
+    *  @remark le contenu précédent de la LinkedList courante est 
+    *  effacé.
+    */
+   LinkedList& operator=(const LinkedList& other) {
+      if (this != &other) {
+         NodePtr currElement = skipDead(other.head);
+         size_t nbToDel = nbElements;
+         size_t exc_safe = 0;
+
+         if (other.size() > 0) {
+            try {
+               while (currElement != nullptr) {
+                  insert(currElement->data, nbElements);
+                  currElement = skipDead(currElement->next);
+                  exc_safe++;
+               }
+            } catch (std::logic_error& e) {
+               del(exc_safe);
+               throw;
+            }
+         }
+
+         for (size_t i = 0; i < nbToDel; i++) {
+            pop_front();
+         }
+      }
+      return *this;
+   }
+
+public:
+
+   /**
+    *  @brief destructeur
+    */
+   ~LinkedList() {
+      compact();
+      while (nbElements) {
+         pop_front();
+      }
+   }
+
+public:
+
+   /**
+    *  @brief nombre d'éléments stockés dans la liste
+    *
+    *  @return nombre d'éléments. 
+    */
+   size_t size() const noexcept {
+      return nbElements;
+   }
+
+public:
+
+   /**
+    *  @brief insertion d'une valeur dans un maillon en tête de liste
+    *
+    *  @param value la valeur à insérer
+    *
+    *  @exception std::bad_alloc si pas assez de mémoire, où toute autre
+    * exception lancée par la constructeur de copie de value_type
+    */
+   void push_front(const_reference value) { // O(1)
+      head = newNode(value, head);
+      if (tail == nullptr) {
+         tail = head;
+      }
+      if (cursor != nullptr) {
+         ++cursorPos;
+      }
+      ++nbElements;
+   }
+
+public:
+
+   /**
+    *  @brief insertion d'une valeur dans un maillon en fin de liste
+    *
+    *  @param value la valeur à insérer
+    *
+    *  @exception std::bad_alloc si pas assez de mémoire, où toute autre
+    * exception lancée par la constructeur de copie de value_type
+    */
+   void push_back(const_reference value) { // O(1)
+      if (tail == nullptr) {
+         push_front(value);
+      } else {
+         tail->next = newNode(value);
+         tail = tail->next;
+         ++nbElements;
+      }
+   }
+
+public:
+
+   /**
+    *  @brief Déplacement des count premiers éléments de other en fin de
+    *  liste, sans copie : les maillons sont rechaînés
+    *
+    *  @param other la liste d'où viennent les éléments, distincte de *this
+    *  @param count le nombre d'éléments à déplacer
+    *
+    *  @exception std::out_of_range("LinkedList::splice_back") si other a
+    *  moins de count éléments
+    */
+   void splice_back(LinkedList& other, size_t count) { // O(count)
+      if (count > other.nbElements || this == &other) {
+         throw out_of_range("LinkedList::splice_back");
+      } else if (count == 0) {
+         return;
+      }
+      other.compact();
+      NodePtr first = other.head;
+      NodePtr last = other.nodeAt(count - 1);
+      other.cursor = nullptr;
+
+      other.head = last->next;
+      if (other.head == nullptr) {
+         other.tail = nullptr;
+      }
+      other.nbElements -= count;
+
+      last->next = nullptr;
+      if (tail == nullptr) {
+         head = first;
+      } else {
+         tail->next = first;
+      }
+      tail = last;
+      nbElements += count;
+   }
+
+public:
+
+   /**
+    *  @brief accès (lecture/écriture) à la valeur en tête de LinkedList
+    *
+    *  @return référence à cette valeur
+    *
+    *  @exception std::runtime_error si la liste est vide
+    */
+   reference front() { // O(1)
+      if (!nbElements) {
+         throw runtime_error("La liste est vide.");
+      }
+      return skipDead(head)->data;
+   }
+
+   const_reference front() const { // O(1)
+      if (!nbElements) {
+         throw runtime_error("La liste est vide.");
+      }
+      return skipDead(head)->data;
+   }
+
+public:
+
+   /**
+    *  @brief Suppression de l'élément en tête de LinkedList
+    *
+    *  @remark les maillons marqués supprimés qui le précèdent sont
+    *  libérés au passage.
+    *
+    *  @exception std::runtime_error si la liste est vide
+    */
+   void pop_front() { // O(1) amorti
+      if (!nbElements) {
+         throw runtime_error("La liste est vide.");
+      }
+      while (head->isDead()) {
+         NodePtr tmp = head;
+         head = head->next;
+         deleteNode(tmp);
+         --nbDead;
+      }
+      if (cursor == head) {
+         cursor = nullptr;
+      } else if (cursor != nullptr) {
+         --cursorPos;
+      }
+      NodePtr tmp = head;
+      head = head->next;
+      deleteNode(tmp);
+      --nbElements;
+      if (head == nullptr) {
+         tail = nullptr;
+      }
+   }
+
+public:
+
+   /**
+    *  @brief Insertion en position quelconque
+    *
+    *  @param value la valeur à insérer
+    *  @param pos   la position où insérer, 0 est la position en tete
+    *
+    *  @exception std::out_of_range("LinkedList::insert") si pos non valide
+    *
+    *  @exception std::bad_alloc si pas assez de mémoire, où toute autre exception lancée par la constructeur de copie de value_type
+    */
+   void insert(const_reference value, size_t pos) {
+      if (pos > nbElements) {
+         throw out_of_range("LinkedList::insert");
+      } else if (pos == 0) {
+         push_front(value);
+      } else if (pos == nbElements) {
+         push_back(value);
+      } else {
+         NodePtr currElement = nodeAt(pos - 1);
+
+         NodePtr newElement = newNode(value, currElement->next);
+         currElement->next = newElement;
+         cursor = newElement;
+         cursorPos = pos;
+         ++nbElements;
+      }
+   }
+
+public:
+
+   /**
+    *  @brief Acces à l'element en position quelconque
+    *
+    *  @param pos la position, 0 est la position en tete
+    * 
+    *  @exception std::out_of_range("LinkedList::at") si pos non valide
+    *
+    *  @return une reference a l'element correspondant dans la liste
+    */
+   reference at(size_t pos) {
+      if (pos > nbElements - 1) {
+         throw out_of_range("LinkedList::at");
+      }
+      return nodeAt(pos)->data;
+   }
+
+   /**
+    *  @brief Acces à l'element en position quelconque
+    *
+    *  @param pos la position, 0 est la position en tete
+    *
+    *  @exception std::out_of_range("LinkedList::at") si pos non valide
+    *
+    *  @return une const_reference a l'element correspondant dans la liste
+    *
+    *  @remark deplace le curseur partagé de la liste : deux threads ne
+    *  peuvent pas appeler at() en meme temps, meme sur une liste const.
+    */
+   const_reference at(size_t pos) const {
+      if (pos > nbElements - 1) {
+         throw out_of_range("LinkedList::at");
+      }
+      return nodeAt(pos)->data;
+   }
+
+public:
+
+   /**
+    *  @brief Suppression en position quelconque
+    *
+    *  @param pos la position, 0 est la position en tete
+    *
+    *  @remark en mode de suppression différée, le maillon est seulement
+    *  marqué et sera libéré par compact().
+    *
+    *  @exception std::out_of_range("LinkedList::erase") si pos non valide
+    */
+   void erase(size_t pos) {
+      if (pos > nbElements - 1) {
+         throw out_of_range("LinkedList::erase");
+      } else if (lazyErase) {
+         NodePtr currElement;
+         if (pos == 0) {
+            currElement = skipDead(head);
+            if (cursor == currElement) {
+               cursor = nullptr;
+            } else if (cursor != nullptr) {
+               --cursorPos;
+            }
+         } else {
+            currElement = skipDead(nodeAt(pos - 1)->next);
+         }
+         currElement->markDead();
+         --nbElements;
+         ++nbDead;
+         if (nbDead > nbElements) {
+            compact();
+         }
+      } else if (pos == 0) {
+         pop_front();
+      } else {
+         NodePtr currElement = nodeAt(pos - 1);
+
+         while (currElement->next->isDead()) {
+            currElement = currElement->next;
+         }
+
+         NodePtr nextElement = currElement->next;
+         currElement->next = nextElement->next;
+         if (nextElement == tail) {
+            tail = currElement;
+         }
+         deleteNode(nextElement);
+         --nbElements;
+      }
+   }
+   
+private:
+      
+   void del(size_t pos) {
+      while (pos) {
+         erase(nbElements - pos);
+         pos--;
+      }
+   }
+
+   /**
+    *  @brief Premier maillon non supprimé à partir de n (compris)
+    */
+   static NodePtr skipDead(NodePtr n) noexcept {
+      while (n != nullptr && n->isDead()) {
+         n = n->next;
+      }
+      return n;
+   }
+
+   /**
+    *  @brief Nombre de maillons préchargés en avance lors de l'affichage
+    */
+   static inline atomic<size_t> prefetchDistance{8};
+
+   /**
+    *  @brief Nombre de maillons préchargés en avance par les recherches
+    *  (find, at, insert, erase), qui s'arrêtent souvent avant la fin de la
+    *  liste et paient alors les préchargements au-delà
+    */
+   static inline atomic<size_t> lookupPrefetchDistance{0};
+
+   /**
+    *  @brief Demande de chargement en cache du maillon n
+    */
+   static void prefetch(NodePtr n) noexcept {
+      if constexpr (CompactLinks) {
+         if (n != nullptr) {
+            __builtin_prefetch(n.operator->());
+         }
+      } else {
+         __builtin_prefetch(n);
+      }
+   }
+
+   /**
+    *  @brief Parcours des maillons vivants, précédé d'un éclaireur qui
+    *  précharge en cache les distance maillons suivants, afin que le
+    *  traitement de chaque élément recouvre l'attente des suivants.
+    *
+    *  L'éclaireur ne fait pas plus de steps pas, pour qu'un parcours court
+    *  ne coûte pas distance accès.
+    */
+   class Walk {
+   public:
+      Walk(NodePtr start, size_t steps,
+           size_t distance = prefetchDistance.load(memory_order_relaxed)) noexcept
+      : curr(skipDead(start)), ahead(curr), aheadSteps(steps) {
+         for (size_t i = 0; i < distance; ++i) {
+            stepAhead();
+         }
+      }
+
+      NodePtr node() const noexcept {
+         return curr;
+      }
+
+      void next() noexcept {
+         curr = skipDead(curr->next);
+         stepAhead();
+      }
+
+   private:
+      void stepAhead() noexcept {
+         if (aheadSteps != 0 && ahead != nullptr) {
+            ahead = ahead->next;
+            prefetch(ahead);
+            --aheadSteps;
+         }
+      }
+
+      NodePtr curr;
+      NodePtr ahead;
+      size_t aheadSteps;
+   };
+
+   /**
+    *  @brief Maillon de l'element en position pos, pos doit etre valide
+    *
+    *  Part du curseur s'il est à ou avant pos, de la tête sinon, puis
+    *  place le curseur sur le maillon trouvé : un parcours par positions
+    *  croissantes coûte O(1) amorti par appel.
+    */
+   NodePtr nodeAt(size_t pos) const noexcept {
+      NodePtr currElement = skipDead(head);
+      size_t i = 0;
+
+      if (cursor != nullptr && cursorPos <= pos) {
+         currElement = cursor;
+         i = cursorPos;
+      }
+      Walk walk(currElement, pos - i, lookupPrefetchDistance.load(memory_order_relaxed));
+      for (; i < pos; ++i) {
+         walk.next();
+      }
+      currElement = walk.node();
+      cursor = currElement;
+      cursorPos = pos;
+      return currElement;
+   }
+
+public:
+
+   /**
+    *  @brief Suppression de tous les éléments vérifiant un prédicat
+    *
+    *  Les éléments sont marqués en un seul parcours, puis libérés en bloc
+    *  par compact() (immédiatement hors du mode de suppression différée).
+    *
+    *  @param pred prédicat appelé sur chaque élément
+    *
+    *  @return le nombre d'éléments supprimés
+    */
+   template <typename Predicate>
+   size_t erase_if(Predicate pred) {
+      size_t nbErased = 0;
+      cursor = nullptr;
+
+      for (NodePtr n = skipDead(head); n != nullptr; n = skipDead(n->next)) {
+         if (pred(n->data)) {
+            n->markDead();
+            --nbElements;
+            ++nbDead;
+            ++nbErased;
+         }
+      }
+      if (!lazyErase || nbDead > nbElements) {
+         compact();
+      }
+      return nbErased;
+   }
+
+   /**
+    *  @brief Active ou désactive la suppression différée
+    *
+    *  En mode différé, erase et erase_if marquent les maillons au lieu de
+    *  les libérer. Ils sont libérés en un seul parcours par compact(),
+    *  appelé automatiquement dès qu'ils sont plus nombreux que les
+    *  éléments restants (coût amorti O(1) par suppression).
+    *
+    *  @remark désactiver le mode libère les maillons en attente.
+    */
+   void set_lazy_erase(bool enable) {
+      lazyErase = enable;
+      if (!lazyErase) {
+         compact();
+      }
+   }
+
+   /**
+    *  @brief Réglage du nombre de maillons préchargés en avance par
+    *  l'affichage (opérateur << et print), 0 pour aucun
+    *
+    *  @remark commun à toutes les listes de ce type. Un affichage en cours
+    *  dans un autre thread garde la distance lue à son début.
+    */
+   static void set_prefetch_distance(size_t distance) noexcept {
+      prefetchDistance.store(distance, memory_order_relaxed);
+   }
+
+   /**
+    *  @brief Réglage du nombre de maillons préchargés en avance par les
+    *  recherches (find, at, insert, erase), 0 pour aucun (par défaut)
+    *
+    *  @remark commun à toutes les listes de ce type. Une recherche en cours
+    *  dans un autre thread garde la distance lue à son début.
+    */
+   static void set_lookup_prefetch_distance(size_t distance) noexcept {
+      lookupPrefetchDistance.store(distance, memory_order_relaxed);
+   }
+
+   /**
+    *  @brief Réglage du nombre de threads des algorithmes policy::par,
+    *  0 pour tous ceux de ThreadPool::shared() plus le thread appelant
+    *
+    *  @remark commun à toutes les listes de ce type. Au-delà, les segments
+    *  supplémentaires attendent un thread libre.
+    */
+   static void set_parallel_threads(size_t nbThreads) noexcept {
+      parallelThreads.store(nbThreads, memory_order_relaxed);
+   }
+
+   /**
+    *  @brief Libération en un seul parcours des maillons marqués supprimés
+    */
+   void compact() noexcept {
+      NodePtr* link = &head;
+      NodePtr prevElement = nullptr;
+
+      while (nbDead) {
+         NodePtr currElement = *link;
+         if (currElement->isDead()) {
+            *link = currElement->next;
+            if (currElement == tail) {
+               tail = prevElement;
+            }
+            deleteNode(currElement);
+            --nbDead;
+         } else {
+            prevElement = currElement;
+            link = &currElement->next;
+         }
+      }
+   }
+
+public:
+
+   /**
+    *  @brief Recherche du premier élément correspondant
+       à une valeur donnée dans la liste
+    *
+    *  @param value la valeur à chercher
+    *
+    *  @return la position dans la liste. -1 si la valeur
+       n'est pas trouvée
+    */
+   size_t find(const_reference value) const noexcept {
+      size_t pos = 0;
+      Walk walk(head, nbElements, lookupPrefetchDistance.load(memory_order_relaxed));
+
+      for (int i = 0; i < nbElements; ++i) {
+         if (walk.node()->data == value) {
+            return pos;
+
+         } else {
+            pos++;
+         }
+         walk.next();
+      }
+
+      return pos = -1;
+   }
+
+private:
+
+   /**
+    *  @brief Nombre minimal d'éléments traités par chaque thread
+    */
+   static constexpr size_t parallelGrain = 4096;
+
+   /**
+    *  @brief Nombre de threads des algorithmes parallèles, 0 pour tous
+    *  ceux de ThreadPool::shared() plus le thread appelant
+    */
+   static inline atomic<size_t> parallelThreads{0};
+
+   /**
+    *  @brief Nombre de segments que forSegments passera à f
+    */
+   size_t segmentCount(policy::sequenced_policy) const noexcept {
+      return 1;
+   }
+
+   size_t segmentCount(policy::parallel_policy) const noexcept {
+      size_t nbThreads = parallelThreads.load(memory_order_relaxed);
+      if (nbThreads == 0) {
+         nbThreads = ThreadPool::shared().size() + 1;
+      }
+      return max(size_t(1), min(nbThreads, (nbElements + parallelGrain - 1) / parallelGrain));
+   }
+
+   /**
+    *  @brief Appelle f(debut, nombre, position, segment) sur toute la liste
+    */
+   template <typename Function>
+   void forSegments(policy::sequenced_policy, Function f, size_t = 1) const {
+      if (nbElements) {
+         f(skipDead(head), nbElements, size_t(0), size_t(0));
+      }
+   }
+
+   /**
+    *  @brief Découpe la liste en segmentCount(par) segments équilibrés en
+    *  un seul parcours et appelle f(debut, nombre, position, segment) sur
+    *  chacun : le premier dans le thread appelant, les autres dans
+    *  ThreadPool::shared(). En attendant ces derniers, le thread appelant
+    *  exécute lui-même ceux qui n'ont pas encore démarré.
+    *
+    *  @param nbSegments résultat de segmentCount(par) si l'appelant en a
+    *  besoin, 0 pour le calculer
+    *
+    *  @remark la première exception levée par f est relancée une fois
+    *  tous les segments terminés.
+    */
+   template <typename Function>
+   void forSegments(policy::parallel_policy exec, Function f, size_t nbSegments = 0) const {
+      if (nbSegments == 0) {
+         nbSegments = segmentCount(exec);
+      }
+      if (nbSegments <= 1) {
+         forSegments(policy::seq, f);
+         return;
+      }
+
+      vector<NodePtr> starts(nbSegments);
+      vector<size_t> firsts(nbSegments + 1);
+      NodePtr currElement = skipDead(head);
+      for (size_t t = 0; t < nbSegments; ++t) {
+         firsts[t] = nbElements * t / nbSegments;
+         firsts[t + 1] = nbElements * (t + 1) / nbSegments;
+         starts[t] = currElement;
+         for (size_t i = firsts[t]; i < firsts[t + 1]; ++i) {
+            currElement = skipDead(currElement->next);
+         }
+      }
+
+      vector<exception_ptr> errors(nbSegments);
+      auto run = [&](size_t t) {
+         try {
+            f(starts[t], firsts[t + 1] - firsts[t], firsts[t], t);
+         } catch (...) {
+            errors[t] = current_exception();
+         }
+      };
+
+      ThreadPool& pool = ThreadPool::shared();
+      mutex lock;
+      condition_variable done;
+      size_t running = 0;
+      auto wait = [&] {
+         unique_lock<mutex> guard(lock);
+         while (running != 0) {
+            guard.unlock();
+            bool helped = pool.run_pending();
+            guard.lock();
+            if (!helped) {
+               done.wait(guard, [&] { return running == 0; });
+            }
+         }
+      };
+
+      try {
+         for (size_t t = 1; t < nbSegments; ++t) {
+            {
+               lock_guard<mutex> guard(lock);
+               ++running;
+            }
+            try {
+               pool.submit([&, t] {
+                  run(t);
+                  lock_guard<mutex> guard(lock);
+                  if (--running == 0) {
+                     done.notify_all();
+                  }
+               });
+            } catch (...) {
+               lock_guard<mutex> guard(lock);
+               --running;
+               throw;
+            }
+         }
+      } catch (...) {
+         wait();
+         throw;
+      }
+      run(0);
+      wait();
+      for (exception_ptr& error : errors) {
+         if (error) {
+            rethrow_exception(error);
+         }
+      }
+   }
+
+public:
+
+   /**
+    *  @brief Application d'une fonction à chaque élément
+    *
+    *  @param exec policy::seq ou policy::par
+    *  @param f    fonction appelée avec une référence sur chaque élément
+    */
+   template <typename Policy, typename Function>
+   void for_each(Policy exec, Function f) {
+      forSegments(exec, [&f](NodePtr n, size_t count, size_t, size_t) {
+         for (size_t i = 0; i < count; ++i, n = skipDead(n->next)) {
+            f(n->data);
+         }
+      });
+   }
+
+   /**
+    *  @brief Remplacement de chaque élément par op(élément)
+    *
+    *  @param exec policy::seq ou policy::par
+    *  @param op   opération unaire
+    */
+   template <typename Policy, typename UnaryOperation>
+   void transform(Policy exec, UnaryOperation op) {
+      for_each(exec, [&op](reference data) {
+         data = op(data);
+      });
+   }
+
+   /**
+    *  @brief Réduction des éléments par une opération binaire
+    *
+    *  @param exec policy::seq ou policy::par
+    *  @param init valeur initiale
+    *  @param op   opération associative : les résultats partiels des
+    *              segments sont combinés dans l'ordre de la liste
+    *
+    *  @return la réduction de init et de tous les éléments
+    */
+   template <typename Policy, typename U, typename BinaryOperation>
+   U reduce(Policy exec, U init, BinaryOperation op) const {
+      vector<optional<U>> partials(segmentCount(exec));
+      forSegments(exec, [&](NodePtr n, size_t count, size_t, size_t segment) {
+         U partial = n->data;
+         for (size_t i = 1; i < count; ++i) {
+            n = skipDead(n->next);
+            partial = op(partial, n->data);
+         }
+         partials[segment].emplace(move(partial));
+      }, partials.size());
+      for (optional<U>& partial : partials) {
+         if (partial) {
+            init = op(init, *partial);
+         }
+      }
+      return init;
+   }
+
+   /**
+    *  @brief Nombre d'éléments vérifiant un prédicat
+    *
+    *  @param exec policy::seq ou policy::par
+    *  @param pred prédicat
+    */
+   template <typename Policy, typename Predicate>
+   size_t count_if(Policy exec, Predicate pred) const {
+      atomic<size_t> total(0);
+      forSegments(exec, [&](NodePtr n, size_t count, size_t, size_t) {
+         size_t partial = 0;
+         for (size_t i = 0; i < count; ++i, n = skipDead(n->next)) {
+            if (pred(n->data)) {
+               ++partial;
+            }
+         }
+         total += partial;
+      });
+      return total;
+   }
+
+   /**
+    *  @brief Recherche du premier élément correspondant à une valeur
+    *
+    *  Un segment s'arrête dès qu'un autre a trouvé la valeur à une
+    *  position inférieure.
+    *
+    *  @param exec  policy::seq ou policy::par
+    *  @param value la valeur à chercher
+    *
+    *  @return la plus petite position de la valeur. -1 si la valeur
+       n'est pas trouvée
+    */
+   template <typename Policy>
+   size_t find(Policy exec, const_reference value) const {
+      atomic<size_t> found(size_t(-1));
+      forSegments(exec, [&](NodePtr n, size_t count, size_t first, size_t) {
+         for (size_t i = 0; i < count; ++i, n = skipDead(n->next)) {
+            size_t pos = first + i;
+            if (pos >= found.load(memory_order_relaxed)) {
+               return;
+            }
+            if (n->data == value) {
+               size_t best = found.load();
+               while (pos < best && !found.compare_exchange_weak(best, pos)) {
+               }
+               return;
+            }
+         }
+      });
+      return found;
+   }
+
+private:
+
+   /**
+    *  @brief Taille à partir de laquelle le tampon de print est vidé
+    */
+   static constexpr size_t printChunk = 1 << 16;
+
+   /**
+    *  @brief Ajout du texte de value au tampon, via std::to_chars pour les
+    *  types arithmétiques si os a son format par défaut, sinon via
+    *  formatter, flux réutilisé d'un élément à l'autre qui a le format de os
+    */
+   template <typename U>
+   static void appendText(string& buffer, ostringstream& formatter, const U& value, bool defaultFormat) {
+      if constexpr (is_floating_point_v<U>) {
+         if (defaultFormat) {
+            char text[64];
+            to_chars_result res = to_chars(text, text + sizeof text, value,
+                                           chars_format::general, int(formatter.precision()));
+            buffer.append(text, res.ptr);
+            return;
+         }
+      } else if constexpr (is_integral_v<U> && !is_same_v<U, bool> && !is_same_v<U, char>
+                           && !is_same_v<U, signed char> && !is_same_v<U, unsigned char>) {
+         if (defaultFormat) {
+            char text[32];
+            to_chars_result res = to_chars(text, text + sizeof text, value);
+            buffer.append(text, res.ptr);
+            return;
+         }
+      }
+      formatter << value;
+      string text = move(formatter).str();
+      buffer += text;
+      text.clear();
+      formatter.str(move(text));
+   }
+
+public:
+
+   /**
+    *  @brief Affichage rapide de la liste par gros blocs
+    *
+    *  Le texte est construit dans un tampon et écrit dans os par blocs de
+    *  64 Kio. Avec les valeurs par défaut, le texte est identique à celui
+    *  de l'opérateur <<. Les nombres passent par std::to_chars si os a ses
+    *  réglages de format et sa locale par défaut ; le reste passe par un
+    *  ostringstream qui a le format de os.
+    *
+    *  @param os        le flux de sortie
+    *  @param prefix    texte écrit entre le nombre d'éléments et le premier
+    *  @param separator texte écrit après chaque élément
+    *
+    *  @return os
+    */
+   ostream& print(ostream& os, const string& prefix = ": ", const string& separator = " ") const {
+      string buffer;
+      ostringstream formatter;
+      formatter.copyfmt(os);
+      bool defaultFormat = os.flags() == (ios_base::dec | ios_base::skipws) && os.width() == 0
+                           && os.getloc() == locale::classic();
+
+      appendText(buffer, formatter, nbElements, defaultFormat);
+      buffer += prefix;
+      for (Walk walk(head, nbElements); walk.node() != nullptr; walk.next()) {
+         appendText(buffer, formatter, walk.node()->data, defaultFormat);
+         buffer += separator;
+         if (buffer.size() >= printChunk) {
+            os.write(buffer.data(), buffer.size());
+            buffer.clear();
+         }
+      }
+      os.width(0);
+      return os.write(buffer.data(), buffer.size());
+   }
+
+private:
+
+   /**
+    *  @brief Nombre de fusions menées de front par sort
+    */
+   static constexpr size_t sortLanes = 4;
+
+   /**
+    *  @brief Fusion stable deux à deux des count chaines triées de in,
+    *  résultats rangés dans l'ordre à partir de out (qui peut être in).
+    *
+    *  Les fusions, indépendantes, avancent d'un maillon chacune à tour de
+    *  rôle : leurs défauts de cache se recouvrent au lieu de s'enchaîner.
+    *
+    *  @return le nombre de chaines produites
+    */
+   template <typename Compare>
+   static size_t mergeRuns(const NodePtr* in, size_t count, NodePtr* out, Compare& comp) {
+      struct Lane {
+         NodePtr a;
+         NodePtr b;
+         NodePtr merged;
+         NodePtr* link;
+      };
+      Lane lanes[sortLanes];
+      size_t nbLanes = count / 2;
+      NodePtr odd = (count % 2) ? in[count - 1] : nullptr;
+
+      for (size_t l = 0; l < nbLanes; ++l) {
+         lanes[l].a = in[2 * l];
+         lanes[l].b = in[2 * l + 1];
+         lanes[l].merged = nullptr;
+         lanes[l].link = &lanes[l].merged;
+      }
+      for (bool active = true; active;) {
+         active = false;
+         for (size_t l = 0; l < nbLanes; ++l) {
+            Lane& lane = lanes[l];
+            if (lane.a == nullptr || lane.b == nullptr) {
+               continue;
+            }
+            if (comp(lane.b->data, lane.a->data)) {
+               *lane.link = lane.b;
+               lane.link = &lane.b->next;
+               lane.b = lane.b->next;
+            } else {
+               *lane.link = lane.a;
+               lane.link = &lane.a->next;
+               lane.a = lane.a->next;
+            }
+            active = true;
+         }
+      }
+      for (size_t l = 0; l < nbLanes; ++l) {
+         *lanes[l].link = (lanes[l].a != nullptr) ? lanes[l].a : lanes[l].b;
+         out[l] = lanes[l].merged;
+      }
+      if (count % 2) {
+         out[nbLanes] = odd;
+      }
+      return nbLanes + count % 2;
+   }
+
+   /**
+    *  @brief Fusion en un seul parcours des maillons de other, triée comme
+    *  *this, dans *this. Les maillons sont déplacés sans copie ; si
+    *  dropEquivalent, ceux de other équivalents à un élément de *this
+    *  sont libérés au lieu d'être déplacés. other est vidée.
+    */
+   template <typename Compare>
+   void mergeFrom(LinkedList& other, Compare& comp, bool dropEquivalent) {
+      if (this == &other) {
+         return;
+      }
+      compact();
+      other.compact();
+      cursor = other.cursor = nullptr;
+
+      NodePtr a = head;
+      NodePtr b = other.head;
+      NodePtr last = nullptr;
+      NodePtr* link = &head;
+      size_t nbDropped = 0;
+
+      while (a != nullptr && b != nullptr) {
+         if (comp(b->data, a->data)) {
+            *link = last = b;
+            b = b->next;
+         } else {
+            if (dropEquivalent && !comp(a->data, b->data)) {
+               NodePtr tmp = b;
+               b = b->next;
+               deleteNode(tmp);
+               ++nbDropped;
+            }
+            *link = last = a;
+            a = a->next;
+         }
+         link = &last->next;
+      }
+      *link = (a != nullptr) ? a : b;
+      if (b != nullptr) {
+         tail = other.tail;
+      } else if (a == nullptr) {
+         tail = last;
+      }
+      nbElements += other.nbElements - nbDropped;
+      other.head = other.tail = nullptr;
+      other.nbElements = 0;
+   }
+
+public:
+
+   /**
+    *  @brief Tri des elements de la liste par tri fusion, stable
+    *
+    *  Les séquences déjà croissantes de la liste sont prises par lots de
+    *  2 * sortLanes, fusionnés en menant sortLanes fusions de front. Comme
+    *  dans std::list::sort, chaque lot est ensuite versé dans 64 casiers,
+    *  le casier i contenant la fusion de 2^i lots : la mémoire
+    *  supplémentaire est constante.
+    *
+    *  @param comp ordre strict faible, ne devant pas lever d'exception
+    */
+   template <typename Compare = less<>>
+   void sort(Compare comp = Compare()) {
+      compact();
+      cursor = nullptr;
+
+      NodePtr bins[64] = {};
+      NodePtr runs[2 * sortLanes];
+      for (NodePtr n = head; n != nullptr;) {
+         size_t nbRuns = 0;
+         while (n != nullptr && nbRuns < 2 * sortLanes) {
+            runs[nbRuns++] = n;
+            NodePtr next = n->next;
+            while (next != nullptr && !comp(next->data, n->data)) {
+               n = next;
+               next = n->next;
+            }
+            n->next = nullptr;
+            n = next;
+         }
+         while (nbRuns > 1) {
+            nbRuns = mergeRuns(runs, nbRuns, runs, comp);
+         }
+
+         // les casiers, plus anciens, précèdent le lot à équivalence
+         size_t i = 0;
+         for (; bins[i] != nullptr; ++i) {
+            NodePtr pair[2] = {bins[i], runs[0]};
+            mergeRuns(pair, 2, runs, comp);
+            bins[i] = nullptr;
+         }
+         bins[i] = runs[0];
+      }
+
+      NodePtr sorted = nullptr;
+      for (NodePtr bin : bins) {
+         if (bin != nullptr) {
+            NodePtr pair[2] = {bin, sorted};
+            mergeRuns(pair, 2, &sorted, comp);
+         }
+      }
+      head = sorted;
+      for (tail = head; tail != nullptr && tail->next != nullptr; tail = tail->next) {
+      }
+   }
+
+   /**
+    *  @brief Fusion de deux listes triées, en temps linéaire
+    *
+    *  Les maillons de other sont déplacés dans la liste sans copie. À
+    *  équivalence, les éléments de la liste précèdent ceux de other.
+    *
+    *  @param other liste triée selon comp, vide après l'appel
+    *  @param comp  ordre strict faible, ne devant pas lever d'exception
+    */
+   template <typename Compare = less<>>
+   void merge(LinkedList& other, Compare comp = Compare()) {
+      mergeFrom(other, comp, false);
+   }
+
+   /**
+    *  @brief Suppression des éléments équivalents à leur prédécesseur
+    *
+    *  Sur une liste triée, ne laisse qu'un exemplaire de chaque valeur.
+    *  Les suppressions suivent le mode de erase_if.
+    *
+    *  @param pred prédicat d'équivalence
+    *
+    *  @return le nombre d'éléments supprimés
+    */
+   template <typename BinaryPredicate = equal_to<>>
+   size_t unique(BinaryPredicate pred = BinaryPredicate()) {
+      NodePtr prev = nullptr;
+      return erase_if([&](reference value) {
+         NodePtr curr = prev;
+         prev = (prev == nullptr) ? skipDead(head) : skipDead(prev->next);
+         return curr != nullptr && pred(curr->data, value);
+      });
+   }
+
+   /**
+    *  @brief Union de deux listes triées, en temps linéaire
+    *
+    *  Comme std::set_union, une valeur présente m fois dans la liste et n
+    *  fois dans other y reste max(m, n) fois. Les maillons manquants sont
+    *  déplacés depuis other sans copie.
+    *
+    *  @param other liste triée selon comp, vide après l'appel
+    *  @param comp  ordre strict faible, ne devant pas lever d'exception
+    */
+   template <typename Compare = less<>>
+   void set_union(LinkedList& other, Compare comp = Compare()) {
+      mergeFrom(other, comp, true);
+   }
+
+   /**
+    *  @brief Intersection de deux listes triées, en temps linéaire
+    *
+    *  Ne garde que les éléments ayant un équivalent non encore apparié
+    *  dans other. Les suppressions suivent le mode de erase_if.
+    *
+    *  @param other liste triée selon comp
+    *  @param comp  ordre strict faible
+    *
+    *  @return le nombre d'éléments supprimés
+    */
+   template <typename Compare = less<>>
+   size_t set_intersection(const LinkedList& other, Compare comp = Compare()) {
+      NodePtr b = skipDead(other.head);
+      return erase_if([&](reference value) {
+         while (b != nullptr && comp(b->data, value)) {
+            b = skipDead(b->next);
+         }
+         if (b != nullptr && !comp(value, b->data)) {
+            b = skipDead(b->next);
+            return false;
+         }
+         return true;
+      });
+   }
+
+   /**
+    *  @brief Différence de deux listes triées, en temps linéaire
+    *
+    *  Chaque élément de other supprime au plus un élément équivalent de
+    *  la liste. Les suppressions suivent le mode de erase_if.
+    *
+    *  @param other liste triée selon comp
+    *  @param comp  ordre strict faible
+    *
+    *  @return le nombre d'éléments supprimés
+    */
+   template <typename Compare = less<>>
+   size_t set_difference(const LinkedList& other, Compare comp = Compare()) {
+      NodePtr b = skipDead(other.head);
+      return erase_if([&](reference value) {
+         while (b != nullptr && comp(b->data, value)) {
+            b = skipDead(b->next);
+         }
+         if (b != nullptr && !comp(value, b->data)) {
+            b = skipDead(b->next);
+            return true;
+         }
+         return false;
+      });
+   }
+};
+
+template <typename T, bool CompactLinks>
+ostream& operator<<(ostream& os, const LinkedList<T, CompactLinks>& liste) {
+   os << liste.size() << ": ";
+   typename LinkedList<T, CompactLinks>::Walk walk(liste.head, liste.size());
+   while (walk.node()) {
+
+      os << walk.node()->data << " ";
+      walk.next();
+   }
+   return os;
+}
+
+#endif /* LINKEDLIST_H */
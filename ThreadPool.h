@@ -0,0 +1,138 @@
+//
+//  ThreadPool.h
+//
+//  Copyright (c) 2016 Olivier Cuisenaire. All rights reserved.
+//
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+/// Groupe de threads exécutant, dans l'ordre d'arrivée, les tâches soumises
+
+class ThreadPool {
+public:
+
+   /**
+    *  @brief Constructeur, démarre nbThreads threads
+    *
+    *  @exception std::system_error si un thread ne peut être créé ; ceux
+    *  déjà démarrés sont alors arrêtés
+    */
+   explicit ThreadPool(size_t nbThreads) {
+      try {
+         for (size_t i = 0; i < nbThreads; ++i) {
+            workers.emplace_back([this] { work(); });
+         }
+      } catch (...) {
+         stop();
+         throw;
+      }
+   }
+
+   ThreadPool(const ThreadPool&) = delete;
+   ThreadPool& operator=(const ThreadPool&) = delete;
+
+   /**
+    *  @brief destructeur, exécute les tâches en attente puis arrête les
+    *  threads
+    */
+   ~ThreadPool() {
+      stop();
+   }
+
+   /**
+    *  @brief nombre de threads du groupe
+    */
+   size_t size() const noexcept {
+      return workers.size();
+   }
+
+   /**
+    *  @brief soumission d'une tâche, qui ne doit pas lever d'exception
+    *
+    *  @exception std::bad_alloc si pas assez de mémoire
+    */
+   void submit(function<void()> task) {
+      {
+         lock_guard<mutex> guard(lock);
+         tasks.push_back(move(task));
+      }
+      wakeUp.notify_one();
+   }
+
+   /**
+    *  @brief exécution dans le thread appelant d'une tâche en attente,
+    *  pour avancer le travail au lieu d'attendre les threads du groupe
+    *
+    *  @return false si aucune tâche n'attendait
+    */
+   bool run_pending() {
+      function<void()> task;
+      {
+         lock_guard<mutex> guard(lock);
+         if (tasks.empty()) {
+            return false;
+         }
+         task = move(tasks.front());
+         tasks.pop_front();
+      }
+      task();
+      return true;
+   }
+
+   /**
+    *  @brief groupe commun aux algorithmes parallèles, d'un thread de moins
+    *  que le nombre de coeurs : le thread appelant fait sa part du travail
+    */
+   static ThreadPool& shared() {
+      static ThreadPool pool(max(thread::hardware_concurrency(), 1u) - 1);
+      return pool;
+   }
+
+private:
+
+   void work() {
+      for (;;) {
+         function<void()> task;
+         {
+            unique_lock<mutex> guard(lock);
+            wakeUp.wait(guard, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+               return;
+            }
+            task = move(tasks.front());
+            tasks.pop_front();
+         }
+         task();
+      }
+   }
+
+   void stop() noexcept {
+      {
+         lock_guard<mutex> guard(lock);
+         stopping = true;
+      }
+      wakeUp.notify_all();
+      for (thread& worker : workers) {
+         worker.join();
+      }
+      workers.clear();
+   }
+
+   vector<thread> workers;
+   deque<function<void()>> tasks;
+   mutex lock;
+   condition_variable wakeUp;
+   bool stopping = false;
+};
+
+#endif /* THREADPOOL_H */
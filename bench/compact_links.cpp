@@ -0,0 +1,71 @@
+//
+//  compact_links.cpp
+//
+//  Mémoire par élément et temps de parcours d'une LinkedList<int> à liens
+//  pointeurs contre une LinkedList<int, true> à indices 32 bits. La
+//  mémoire est celle que malloc a en usage (glibc), arrondis de
+//  l'allocateur et blocs de NodeTable compris.
+//
+//  usage : compact_links [nbElements]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "LinkedList.h"
+
+using namespace std;
+
+static double heapBytes() {
+#ifdef __GLIBC__
+   struct mallinfo2 info = mallinfo2();
+   return double(info.uordblks + info.hblkhd);
+#else
+   return 0;
+#endif
+}
+
+template <bool CompactLinks>
+static void measure(const char* name, size_t n) {
+   double before = heapBytes();
+   LinkedList<int, CompactLinks> liste;
+   for (size_t i = 0; i < n; ++i) {
+      liste.push_back(int(i));
+   }
+   double bytes = (heapBytes() - before) / n;
+
+   const int rounds = 5;
+   long sum = 0;
+   auto start = chrono::steady_clock::now();
+   for (int r = 0; r < rounds; ++r) {
+      sum += liste.reduce(policy::seq, 0L, [](long a, long b) { return a + b; });
+   }
+   double reduceNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (rounds * double(n));
+
+   start = chrono::steady_clock::now();
+   for (int r = 0; r < rounds; ++r) {
+      sum += liste.find(-1);
+   }
+   double findNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (rounds * double(n));
+
+   printf("%-20s %14.1f %14.2f %14.2f%s\n", name, bytes, reduceNs, findNs,
+          sum == rounds * (long(n) * (long(n) - 1) / 2 - 1) ? "" : "  RESULTAT FAUX");
+}
+
+int main(int argc, const char* argv[]) {
+   size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000000;
+
+   // les maillons tracent leur construction sur cout
+   cout.rdbuf(nullptr);
+
+   printf("%zu éléments int\n", n);
+   printf("%-20s %14s %14s %14s\n", "liens", "octets/élément", "reduce ns/él.", "find ns/él.");
+   measure<false>("pointeurs", n);
+   measure<true>("indices 32 bits", n);
+   return EXIT_SUCCESS;
+}
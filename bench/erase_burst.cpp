@@ -0,0 +1,83 @@
+//
+//  erase_burst.cpp
+//
+//  Rafales de suppressions : suppression immédiate contre suppression
+//  différée (maillons marqués puis libérés en bloc par compact()).
+//
+//  usage : erase_burst [nbElements]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "LinkedList.h"
+
+using namespace std;
+
+static double millisSince(chrono::steady_clock::time_point start) {
+   return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static void fill(LinkedList<int>& liste, size_t n) {
+   for (size_t i = 0; i < n; ++i) {
+      liste.push_back(int(i));
+   }
+}
+
+/// Suppression de positions aléatoires, la moitié de la liste
+static double randomBurst(size_t n, bool lazy) {
+   LinkedList<int> liste;
+   fill(liste, n);
+   liste.set_lazy_erase(lazy);
+   mt19937 rng(42);
+
+   auto start = chrono::steady_clock::now();
+   for (size_t i = 0; i < n / 2; ++i) {
+      liste.erase(rng() % liste.size());
+   }
+   liste.compact();
+   return millisSince(start);
+}
+
+/// Suppression d'un élément sur deux, de la tête vers la queue
+static double forwardBurst(size_t n, bool lazy) {
+   LinkedList<int> liste;
+   fill(liste, n);
+   liste.set_lazy_erase(lazy);
+
+   auto start = chrono::steady_clock::now();
+   for (size_t pos = 0; pos < liste.size(); ++pos) {
+      liste.erase(pos);
+   }
+   liste.compact();
+   return millisSince(start);
+}
+
+/// Suppression d'un élément sur deux par erase_if
+static double eraseIf(size_t n, bool lazy) {
+   LinkedList<int> liste;
+   fill(liste, n);
+   liste.set_lazy_erase(lazy);
+
+   auto start = chrono::steady_clock::now();
+   liste.erase_if([](int v) { return v % 2 == 0; });
+   liste.compact();
+   return millisSince(start);
+}
+
+int main(int argc, const char* argv[]) {
+   size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20000;
+
+   // les maillons tracent leur construction sur cout
+   cout.rdbuf(nullptr);
+
+   printf("%zu éléments, %zu suppressions par rafale (temps en ms, compact() compris)\n", n, n / 2);
+   printf("%-32s %12s %12s\n", "rafale", "immédiate", "différée");
+   printf("%-32s %12.1f %12.1f\n", "erase(position aléatoire)", randomBurst(n, false), randomBurst(n, true));
+   printf("%-32s %12.1f %12.1f\n", "erase(pos) un sur deux", forwardBurst(n, false), forwardBurst(n, true));
+   printf("%-32s %12.1f %12.1f\n", "erase_if un sur deux", eraseIf(n, false), eraseIf(n, true));
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+//
+//  index_loop.cpp
+//
+//  Boucle for (i = 0; i < size(); ++i) liste.at(i) : parcours depuis la
+//  tête à chaque appel (comportement d'origine, reproduit en ramenant le
+//  curseur en tête par at(0) avant chaque accès) contre reprise au
+//  curseur du dernier accès.
+//
+//  usage : index_loop [nbElements]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "LinkedList.h"
+
+using namespace std;
+
+static double millisSince(chrono::steady_clock::time_point start) {
+   return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+template <typename List>
+static double indexLoop(List& liste, bool fromHead, long& sum) {
+   auto start = chrono::steady_clock::now();
+   for (size_t i = 0; i < liste.size(); ++i) {
+      if (fromHead) {
+         sum += liste.at(0);
+      }
+      sum += liste.at(i);
+   }
+   return millisSince(start);
+}
+
+int main(int argc, const char* argv[]) {
+   size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20000;
+
+   // les maillons tracent leur construction sur cout
+   cout.rdbuf(nullptr);
+
+   LinkedList<int> liste;
+   for (size_t i = 0; i < n; ++i) {
+      liste.push_back(int(i));
+   }
+   const LinkedList<int>& constante = liste;
+   long sum = 0;
+
+   printf("%zu éléments, at(i) pour i croissant (temps en ms)\n", n);
+   printf("%-24s %12s %12s\n", "boucle", "avant", "après");
+   printf("%-24s %12.2f %12.2f\n", "at(i)", indexLoop(liste, true, sum), indexLoop(liste, false, sum));
+   printf("%-24s %12.2f %12.2f\n", "at(i) const", indexLoop(constante, true, sum), indexLoop(constante, false, sum));
+   return sum == 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,70 @@
+//
+//  parallel_scaling.cpp
+//
+//  Passage à l'échelle des algorithmes policy::par de 1 à nbThreads
+//  threads (set_parallel_threads), comparés à policy::seq. Au-delà du
+//  nombre de coeurs, les segments en trop attendent un thread libre.
+//
+//  usage : parallel_scaling [nbElements [nbThreads]]
+//
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+#include "LinkedList.h"
+
+using namespace std;
+
+using List = LinkedList<double>;
+
+template <typename Function>
+static double millis(Function f) {
+   auto start = chrono::steady_clock::now();
+   f();
+   return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+template <typename Policy>
+static void row(const char* name, List& liste, Policy exec, double& check) {
+   printf("%-8s %12.1f", name, millis([&] {
+      liste.for_each(exec, [](double& v) { v = sqrt(v * v + 1.0); });
+   }));
+   printf(" %12.1f", millis([&] {
+      check += liste.reduce(exec, 0.0, [](double a, double b) { return a + b; });
+   }));
+   printf(" %12.1f", millis([&] {
+      check += liste.count_if(exec, [](double v) { return sin(v) > 0.5; });
+   }));
+   printf(" %12.1f\n", millis([&] {
+      check += liste.find(exec, -1.0);
+   }));
+}
+
+int main(int argc, const char* argv[]) {
+   size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000000;
+   size_t maxThreads = argc > 2 ? strtoul(argv[2], nullptr, 10)
+                                : max(thread::hardware_concurrency(), 1u);
+
+   // les maillons tracent leur construction sur cout
+   cout.rdbuf(nullptr);
+
+   List liste;
+   for (size_t i = 0; i < n; ++i) {
+      liste.push_back(double(i));
+   }
+   double check = 0;
+
+   printf("%zu éléments, %u coeurs (temps en ms)\n", n, thread::hardware_concurrency());
+   printf("%-8s %12s %12s %12s %12s\n", "threads", "for_each", "reduce", "count_if", "find");
+   row("seq", liste, policy::seq, check);
+   for (size_t t = 1; t <= maxThreads; ++t) {
+      List::set_parallel_threads(t);
+      char name[16];
+      snprintf(name, sizeof name, "par %zu", t);
+      row(name, liste, policy::par, check);
+   }
+   return check != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
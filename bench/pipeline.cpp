@@ -0,0 +1,181 @@
+//
+//  pipeline.cpp
+//
+//  Débit d'un pipeline à trois étages (production, transformation, somme)
+//  dont les étages communiquent par des files bornées de capacité 64 :
+//  un thread par étage avec une LinkedList protégée par mutex et variables
+//  de condition, contre des coroutines reliées par des Channel, sur un
+//  InlineExecutor ou un ThreadPoolExecutor, avec réception unitaire ou par
+//  lots.
+//
+//  usage : pipeline [nbElements]
+//
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+
+#include "Channel.h"
+#include "LinkedList.h"
+
+using namespace std;
+
+static const size_t capacity = 64;
+
+/// File bornée bloquante, comme celles qu'utilisent les étages à threads
+class BlockingQueue {
+public:
+   void push(int value) {
+      unique_lock<mutex> guard(lock);
+      notFull.wait(guard, [this] { return items.size() < capacity; });
+      items.push_back(value);
+      notEmpty.notify_one();
+   }
+
+   bool pop(int& value) {
+      unique_lock<mutex> guard(lock);
+      notEmpty.wait(guard, [this] { return items.size() > 0 || closed; });
+      if (items.size() == 0) {
+         return false;
+      }
+      value = items.front();
+      items.pop_front();
+      notFull.notify_one();
+      return true;
+   }
+
+   void close() {
+      lock_guard<mutex> guard(lock);
+      closed = true;
+      notEmpty.notify_all();
+   }
+
+private:
+   LinkedList<int> items;
+   mutex lock;
+   condition_variable notFull;
+   condition_variable notEmpty;
+   bool closed = false;
+};
+
+static long threadPipeline(int n) {
+   BlockingQueue first, second;
+   long sum = 0;
+
+   thread producer([&] {
+      for (int i = 0; i < n; ++i) {
+         first.push(i);
+      }
+      first.close();
+   });
+   thread transformer([&] {
+      int value;
+      while (first.pop(value)) {
+         second.push(value * 3 + 1);
+      }
+      second.close();
+   });
+   int value;
+   while (second.pop(value)) {
+      sum += value;
+   }
+   producer.join();
+   transformer.join();
+   return sum;
+}
+
+Task produce(Channel<int>& out, int n) {
+   for (int i = 0; i < n; ++i) {
+      co_await out.send(i);
+   }
+   out.close();
+}
+
+Task transform(Channel<int>& in, Channel<int>& out) {
+   while (optional<int> value = co_await in.receive()) {
+      co_await out.send(*value * 3 + 1);
+   }
+   out.close();
+}
+
+Task transformBatch(Channel<int>& in, Channel<int>& out) {
+   LinkedList<int> batch;
+   while (co_await in.receive_batch(batch, capacity)) {
+      while (batch.size()) {
+         co_await out.send(batch.front() * 3 + 1);
+         batch.pop_front();
+      }
+   }
+   out.close();
+}
+
+Task sum(Channel<int>& in, long& total) {
+   while (optional<int> value = co_await in.receive()) {
+      total += *value;
+   }
+}
+
+Task sumBatch(Channel<int>& in, long& total) {
+   LinkedList<int> batch;
+   while (co_await in.receive_batch(batch, capacity)) {
+      while (batch.size()) {
+         total += batch.front();
+         batch.pop_front();
+      }
+   }
+}
+
+static long coroutinePipeline(Executor& executor, int n, bool batch) {
+   Channel<int> first(executor, capacity), second(executor, capacity);
+   long total = 0;
+
+   executor.spawn(produce(first, n));
+   executor.spawn(batch ? transformBatch(first, second) : transform(first, second));
+   executor.spawn(batch ? sumBatch(second, total) : sum(second, total));
+   executor.run();
+   return total;
+}
+
+template <typename Function>
+static void measure(const char* name, int n, Function pipeline) {
+   auto start = chrono::steady_clock::now();
+   long total = pipeline();
+   double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+   long expected = 3L * n * (n - 1) / 2 + n;
+   printf("%-36s %10.2f Méléments/s%s\n", name, n / seconds / 1e6,
+          total == expected ? "" : "  RESULTAT FAUX");
+}
+
+int main(int argc, const char* argv[]) {
+   int n = argc > 1 ? atoi(argv[1]) : 200000;
+
+   // les maillons tracent leur construction sur cout
+   cout.rdbuf(nullptr);
+
+   printf("%d éléments, files de capacité %zu, %u coeurs\n", n, capacity,
+          thread::hardware_concurrency());
+   measure("threads + mutex + LinkedList", n, [n] {
+      return threadPipeline(n);
+   });
+   measure("coroutines, InlineExecutor", n, [n] {
+      InlineExecutor executor;
+      return coroutinePipeline(executor, n, false);
+   });
+   measure("coroutines, InlineExecutor, lots", n, [n] {
+      InlineExecutor executor;
+      return coroutinePipeline(executor, n, true);
+   });
+   measure("coroutines, ThreadPoolExecutor", n, [n] {
+      ThreadPoolExecutor executor;
+      return coroutinePipeline(executor, n, false);
+   });
+   measure("coroutines, ThreadPoolExecutor, lots", n, [n] {
+      ThreadPoolExecutor executor;
+      return coroutinePipeline(executor, n, true);
+   });
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,93 @@
+//
+//  prefetch_traversal.cpp
+//
+//  Parcours d'une liste dont les maillons sont dispersés en mémoire
+//  (valeurs mélangées puis triées), sans préchargement et avec 8 maillons
+//  préchargés en avance par les recherches (set_lookup_prefetch_distance)
+//  et par l'affichage (set_prefetch_distance), puis tri de la liste.
+//  Chaque parcours garde le meilleur de 3 essais.
+//
+//  usage : prefetch_traversal [nbElements]
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "LinkedList.h"
+
+using namespace std;
+
+/// Tampon de sortie qui ne fait que compter les caractères reçus
+class CountingBuffer : public streambuf {
+public:
+   size_t count = 0;
+
+protected:
+   int_type overflow(int_type c) override {
+      ++count;
+      return c;
+   }
+
+   streamsize xsputn(const char*, streamsize n) override {
+      count += n;
+      return n;
+   }
+};
+
+/// Meilleur temps de rounds exécutions de f
+template <typename Function>
+static double millis(Function f, int rounds = 3) {
+   double best = 0;
+   for (int r = 0; r < rounds; ++r) {
+      auto start = chrono::steady_clock::now();
+      f();
+      double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+      best = (r == 0) ? elapsed : min(best, elapsed);
+   }
+   return best;
+}
+
+int main(int argc, const char* argv[]) {
+   size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10000000;
+
+   // les maillons tracent leur construction sur cout
+   cout.rdbuf(nullptr);
+
+   vector<int> values(n);
+   for (size_t i = 0; i < n; ++i) {
+      values[i] = int(i);
+   }
+   shuffle(values.begin(), values.end(), mt19937(42));
+   LinkedList<int> liste;
+   for (int v : values) {
+      liste.push_back(v);
+   }
+   liste.sort();
+
+   CountingBuffer buffer;
+   ostream out(&buffer);
+   long check = 0;
+
+   printf("%zu maillons dispersés (temps en ms)\n", n);
+   printf("%-12s %10s %10s %12s %10s\n", "distance", "find", "at(n-1)", "operator<<", "print");
+   for (size_t distance : {0, 8}) {
+      LinkedList<int>::set_lookup_prefetch_distance(distance);
+      LinkedList<int>::set_prefetch_distance(distance);
+      printf("%-12zu", distance);
+      printf(" %10.1f", millis([&] { check += liste.find(-1); }));
+      printf(" %10.1f", millis([&] {
+         liste.at(0);
+         check += liste.at(n - 1);
+      }));
+      printf(" %12.1f", millis([&] { out << liste; }));
+      printf(" %10.1f\n", millis([&] { liste.print(out); }));
+   }
+   printf("sort         %10.1f\n", millis([&] { liste.sort(greater<int>()); }, 1));
+   return check == 6 * (long(n) - 2) && liste.front() == int(n) - 1 && buffer.count != 0
+          ? EXIT_SUCCESS : EXIT_FAILURE;
+}
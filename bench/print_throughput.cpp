@@ -0,0 +1,106 @@
+//
+//  print_throughput.cpp
+//
+//  Débit d'affichage d'une liste d'int et d'une liste de double par
+//  l'opérateur << et par print(), dans un tampon qui ne fait que compter
+//  les caractères et dans un fichier. Les deux textes sont comparés.
+//
+//  usage : print_throughput [nbElements [fichier]]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+#include <sstream>
+
+#include "LinkedList.h"
+
+using namespace std;
+
+/// Tampon de sortie qui ne fait que compter les caractères reçus
+class CountingBuffer : public streambuf {
+public:
+   size_t count = 0;
+
+protected:
+   int_type overflow(int_type c) override {
+      ++count;
+      return c;
+   }
+
+   streamsize xsputn(const char*, streamsize n) override {
+      count += n;
+      return n;
+   }
+};
+
+/// Meilleur débit en Mo/s de 3 affichages de size octets par f
+template <typename Function>
+static double megabytesPerSecond(size_t size, Function f) {
+   double best = 0;
+   for (int r = 0; r < 3; ++r) {
+      auto start = chrono::steady_clock::now();
+      f();
+      double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+      best = max(best, size / seconds / 1e6);
+   }
+   return best;
+}
+
+static bool failed = false;
+
+template <typename T>
+static void measure(const char* name, const LinkedList<T>& liste, const char* path) {
+   ostringstream expected, result;
+   expected << liste;
+   liste.print(result);
+   failed = failed || expected.str() != result.str();
+   size_t size = expected.str().size();
+
+   CountingBuffer buffer;
+   ostream counter(&buffer);
+   double countingOp = megabytesPerSecond(size, [&] { counter << liste; });
+   double countingPrint = megabytesPerSecond(size, [&] { liste.print(counter); });
+
+   ofstream file(path);
+   double fileOp = megabytesPerSecond(size, [&] {
+      file.seekp(0);
+      file << liste << flush;
+   });
+   double filePrint = megabytesPerSecond(size, [&] {
+      file.seekp(0);
+      liste.print(file) << flush;
+   });
+   failed = failed || !file;
+
+   printf("%-10s %8.1f %10.1f %10.1f %10.1f %10.1f%s\n", name, size / 1e6,
+          countingOp, countingPrint, fileOp, filePrint,
+          expected.str() == result.str() ? "" : "  RESULTAT FAUX");
+}
+
+int main(int argc, const char* argv[]) {
+   size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000000;
+   const char* path = argc > 2 ? argv[2] : "print_throughput.out";
+
+   // les maillons tracent leur construction sur cout
+   cout.rdbuf(nullptr);
+
+   mt19937 rng(42);
+   uniform_real_distribution<double> real(-1e6, 1e6);
+   LinkedList<int> entiers;
+   LinkedList<double> reels;
+   for (size_t i = 0; i < n; ++i) {
+      entiers.push_back(int(rng()));
+      reels.push_back(real(rng));
+   }
+
+   printf("%zu éléments, débit en Mo/s (meilleur de 3)\n", n);
+   printf("%-10s %8s %10s %10s %10s %10s\n", "type", "Mo", "compteur <<", "print",
+          "fichier <<", "print");
+   measure("int", entiers, path);
+   measure("double", reels, path);
+   remove(path);
+   return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,136 @@
+//
+//  set_operations.cpp
+//
+//  Opérations ensemblistes sur deux listes triées de valeurs distinctes :
+//  approche naïve par find imbriqué dans une boucle sur at(i), en O(n^2),
+//  contre set_union, set_intersection, set_difference et unique, en un
+//  seul parcours. Les résultats des deux approches sont comparés.
+//
+//  usage : set_operations [nbElements]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "LinkedList.h"
+
+using namespace std;
+
+using List = LinkedList<int>;
+
+template <typename Function>
+static double millis(Function f) {
+   auto start = chrono::steady_clock::now();
+   f();
+   return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+static vector<int> values(const List& liste) {
+   vector<int> result;
+   for (size_t i = 0; i < liste.size(); ++i) {
+      result.push_back(liste.at(i));
+   }
+   return result;
+}
+
+static bool contains(const List& liste, int value) {
+   return liste.find(value) != size_t(-1);
+}
+
+static bool failed = false;
+
+template <typename Naive, typename Linear>
+static void compare(const char* name, Naive naive, Linear linear) {
+   List expected, result;
+   double naiveMs = millis([&] { expected = naive(); });
+   double linearMs = millis([&] { result = linear(); });
+   bool same = values(expected) == values(result);
+   failed = failed || !same;
+   printf("%-20s %12.2f %12.2f %10.0fx%s\n", name, naiveMs, linearMs, naiveMs / linearMs,
+          same ? "" : "  RESULTAT FAUX");
+}
+
+int main(int argc, const char* argv[]) {
+   size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 5000;
+
+   // les maillons tracent leur construction sur cout
+   cout.rdbuf(nullptr);
+
+   mt19937 rng(42);
+   List a, b, duplicates;
+   for (size_t i = 0; i < n; ++i) {
+      a.push_back(int(2 * i + rng() % 2));
+      b.push_back(int(2 * i + rng() % 2));
+   }
+   for (size_t i = 0; i < n; ++i) {
+      unsigned copies = 1 + rng() % 3;
+      for (unsigned k = 0; k < copies; ++k) {
+         duplicates.push_back(a.at(i));
+      }
+   }
+
+   printf("%zu éléments par liste (temps en ms)\n", n);
+   printf("%-20s %12s %12s %11s\n", "opération", "find imbriqué", "linéaire", "gain");
+
+   compare("set_union", [&] {
+      List result = a;
+      for (size_t i = 0; i < b.size(); ++i) {
+         if (!contains(a, b.at(i))) {
+            result.push_back(b.at(i));
+         }
+      }
+      result.sort();
+      return result;
+   }, [&] {
+      List result = a, other = b;
+      result.set_union(other);
+      return result;
+   });
+
+   compare("set_intersection", [&] {
+      List result;
+      for (size_t i = 0; i < a.size(); ++i) {
+         if (contains(b, a.at(i))) {
+            result.push_back(a.at(i));
+         }
+      }
+      return result;
+   }, [&] {
+      List result = a;
+      result.set_intersection(b);
+      return result;
+   });
+
+   compare("set_difference", [&] {
+      List result;
+      for (size_t i = 0; i < a.size(); ++i) {
+         if (!contains(b, a.at(i))) {
+            result.push_back(a.at(i));
+         }
+      }
+      return result;
+   }, [&] {
+      List result = a;
+      result.set_difference(b);
+      return result;
+   });
+
+   compare("unique", [&] {
+      List result;
+      for (size_t i = 0; i < duplicates.size(); ++i) {
+         if (!contains(result, duplicates.at(i))) {
+            result.push_back(duplicates.at(i));
+         }
+      }
+      return result;
+   }, [&] {
+      List result = duplicates;
+      result.unique();
+      return result;
+   });
+
+   return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
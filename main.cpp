@@ -7,402 +7,10 @@
 #include <iostream>
 #include <stdexcept>
 
-using namespace std;
-
-/// Forward declaration classe
-template < typename T > class LinkedList;
-
-/// Forward declaration fonction d'affichage
-template <typename T>
-ostream& operator<<(ostream& os, const LinkedList<T>& liste);
-
-/// Classe de liste chainee
-
-template < typename T > class LinkedList {
-   friend ostream& operator<< <T>(ostream& os, const LinkedList<T>& liste);
-   //friend class Int;
-public:
-   using value_type = T;
-   using reference = T&;
-   using const_reference = const T&;
-   using pointer = T*;
-   using const_pointer = const T*;
-
-private:
-
-   /**
-    *  @brief Maillon de la chaine.
-    * 
-    * contient une valeur et le lien vers le maillon suivant.
-    */
-   struct Node {
-      value_type data;
-      Node* next;
-
-      Node(const_reference data, Node* next = nullptr)
-      : data(data), next(next) {
-         cout << "(C" << data << ") ";
-      }
-      Node(Node&) = delete;
-      Node(Node&&) = delete;
-
-      ~Node() {
-         cout << "(D" << data << ") ";
-      }
-   };
-
-private:
-   /**
-    *  @brief  Tete de la LinkedList
-    */
-   Node* head;
-
-private:
-   /**
-    *  @brief Nombre d'éléments
-    */
-   size_t nbElements;
-   
-   public:
-
-   /**
-    *  @brief Constructeur par défaut. Construit une LinkedList vide
-    *
-    */
-   LinkedList() : nbElements(0), head(nullptr) {
-   }
-
-public:
-
-   /**
-    *  @brief Constructeur de copie
-    *
-    *  @param other la LinkedList à copier
-    */
-   LinkedList(LinkedList& other) : nbElements(0), head(nullptr) {
-      *this = other;
-   }
-
-public:
-
-   /**
-    *  @brief Opérateur d'affectation par copie
-    *
-    *  @param other la LinkedList à copier
-    *
-    *  @return la LinkedList courante *this (par référence)
-    *
-    *  @remark l'opérateur doit être une no-op si other 
-    *  est la LinkedList courante.
-    *
-    *  @remark le contenu précédent de la LinkedList courante est 
-    *  effacé.
-    */
-   LinkedList& operator=(const LinkedList& other) {
-      if (this != &other) {
-         Node* currElement = head;
-         size_t nbToDel = nbElements;
-         size_t exc_safe = 0;
-
-         if (other.size() > 0) {
-            try {
-               insert(other.head->data, nbElements);
-               currElement = other.head->next;
-               exc_safe++;
-
-               while (currElement != nullptr) {
-                  insert(currElement->data, nbElements);
-                  currElement = currElement->next;
-                  exc_safe++;
-               }
-            } catch (std::logic_error& e) {
-               del(exc_safe);
-               throw;
-            }
-         }
-
-         for (size_t i = 0; i < nbToDel; i++) {
-            pop_front();
-         }
-      }
-      return *this;
-   }
-
-public:
-
-   /**
-    *  @brief destructeur
-    */
-   ~LinkedList() {
-      while (nbElements) {
-         pop_front();
-      }
-   }
-
-public:
-
-   /**
-    *  @brief nombre d'éléments stockés dans la liste
-    *
-    *  @return nombre d'éléments. 
-    */
-   size_t size() const noexcept {
-      return nbElements;
-   }
-
-public:
-
-   /**
-    *  @brief insertion d'une valeur dans un maillon en tête de liste
-    *
-    *  @param value la valeur à insérer
-    *
-    *  @exception std::bad_alloc si pas assez de mémoire, où toute autre
-    * exception lancée par la constructeur de copie de value_type
-    */
-   void push_front(const_reference value) { // O(1)
-      head = new Node{value, head};
-      ++nbElements;
-   }
-
-public:
-
-   /**
-    *  @brief accès (lecture/écriture) à la valeur en tête de LinkedList
-    *
-    *  @return référence à cette valeur
-    *
-    *  @exception std::runtime_error si la liste est vide
-    */
-   reference front() { // O(1)
-      if (!nbElements) {
-         throw runtime_error("La liste est vide.");
-      }
-      return head->data;
-   }
-
-   const_reference front() const { // O(1)
-      if (!nbElements) {
-         throw runtime_error("La liste est vide.");
-      }
-      return head->data;
-   }
-
-public:
-
-   /**
-    *  @brief Suppression de l'élément en tête de LinkedList
-    *
-    *  @exception std::runtime_error si la liste est vide
-    */
-   void pop_front() { // O(1)
-      if (!nbElements) {
-         throw runtime_error("La liste est vide.");
-      }
-      Node* tmp = head;
-      head = head->next;
-      delete tmp;
-      --nbElements;
-   }
-
-public:
-
-   /**
-    *  @brief Insertion en position quelconque
-    *
-    *  @param value la valeur à insérer
-    *  @param pos   la position où insérer, 0 est la position en tete
-    *
-    *  @exception std::out_of_range("LinkedList::insert") si pos non valide
-    *
-    *  @exception std::bad_alloc si pas assez de mémoire, où toute autre exception lancée par la constructeur de copie de value_type
-    */
-   void insert(const_reference value, size_t pos) {
-      if (pos > nbElements) {
-         throw out_of_range("LinkedList::insert");
-      } else if (pos == 0) {
-         push_front(value);
-      } else {
-         Node* currElement = head;
-
-         for (size_t i = 0; i < pos - 1; ++i) {
-            currElement = currElement->next;
-         }
-
-         Node* newElement = new Node{value, currElement->next};
-         currElement->next = newElement;
-         ++nbElements;
-      }
-   }
-
-public:
-
-   /**
-    *  @brief Acces à l'element en position quelconque
-    *
-    *  @param pos la position, 0 est la position en tete
-    * 
-    *  @exception std::out_of_range("LinkedList::at") si pos non valide
-    *
-    *  @return une reference a l'element correspondant dans la liste
-    */
-   reference at(size_t pos) {
-      if (pos > nbElements - 1) {
-         throw out_of_range("LinkedList::at");
-      }
-      Node* currElement = head;
-
-      for (size_t i = 0; i < pos; ++i) {
-         currElement = currElement->next;
-      }
-      return currElement->data;
-   }
-
-   /**
-    *  @brief Acces à l'element en position quelconque
-    *
-    *  @param pos la position, 0 est la position en tete
-    *
-    *  @exception std::out_of_range("LinkedList::at") si pos non valide
-    *
-    *  @return une const_reference a l'element correspondant dans la liste
-    */
-   const_reference at(size_t pos) const {
-      if (pos > nbElements - 1) {
-         throw out_of_range("LinkedList::at");
-      }
-      const Node* currElement = head;
-
-      for (size_t i = 0; i < pos; ++i) {
-         currElement = currElement->next;
-      }
-      return currElement->data;
-   }
-
-public:
+#include "Channel.h"
+#include "LinkedList.h"
 
-   /**
-    *  @brief Suppression en position quelconque
-    *
-    *  @param pos la position, 0 est la position en tete
-    *
-    *  @exception std::out_of_range("LinkedList::erase") si pos non valide
-    */
-   void erase(size_t pos) {
-      if (pos > nbElements - 1) {
-         throw out_of_range("LinkedList::erase");
-      } else if (pos == 0) {
-         pop_front();
-      } else {
-         Node* currElement = head;
-
-         for (size_t i = 0; i < pos - 1; ++i) {
-            currElement = currElement->next;
-         }
-
-         Node* nextElement = currElement->next;
-         currElement->next = nextElement->next;
-         delete nextElement;
-         --nbElements;
-      }
-   }
-   
-private:
-      
-   void del(size_t pos) {
-      while (pos) {
-         erase(nbElements - pos);
-         pos--;
-      }
-   }
-
-public:
-
-   /**
-    *  @brief Recherche du premier élément correspondant
-       à une valeur donnée dans la liste
-    *
-    *  @param value la valeur à chercher
-    *
-    *  @return la position dans la liste. -1 si la valeur
-       n'est pas trouvée
-    */
-   size_t find(const_reference value) const noexcept {
-      size_t pos = 0;
-      Node* currElement = head;
-
-      for (int i = 0; i < nbElements; ++i) {
-         if (currElement->data == value) {
-            return pos;
-
-         } else {
-            pos++;
-         }
-         currElement = currElement->next;
-      }
-
-      return pos = -1;
-   }
-
-   /**
-    *  @brief Tri des elements de la liste par tri fusion
-    */
-
-   void swapElements(Node*& a, Node*& b) {
-      swap(a, b);
-      swap(a->next, b->next);
-   }
-
-   Node*& merge(Node*& start, Node* middle, Node* end) {
-      size_t pos = 0;
-      while (start != middle) {
-         if (start->data < middle->data) {
-            swapElements(middle, start);
-            start = start->next;
-            pos++;
-         } else {
-            swapElements(start, middle);
-            middle = middle->next;
-            pos++;
-         }
-
-      }
-      return start;
-   }
-
-   Node*& mergeSort(Node*& start, size_t nbElement) {
-      if (nbElement > 0) {
-         size_t middle = nbElements / 2;
-         Node *half = head, *full = head;
-         while (full && full->next) {
-            half = half->next;
-            full = full->next->next;
-         }
-
-         mergeSort(start, middle);
-         mergeSort(half, nbElement);
-         merge(start, half, full);
-      }
-      return start;
-
-   }
-
-   void sort() {
-      mergeSort(head, nbElements);
-   }
-};
-
-template <typename T>
-ostream& operator<<(ostream& os, const LinkedList<T>& liste) {
-   os << liste.size() << ": ";
-   auto n = liste.head;
-   while (n) {
-
-      os << n->data << " ";
-      n = n->next;
-   }
-   return os;
-}
+using namespace std;
 
 class Int {
    int val;
@@ -444,6 +52,19 @@ ostream& operator<<(ostream& os, const Int& i) {
 
 using T = Int;
 
+Task producteur(Channel<T>& canal, int n) {
+   for (int i = 0; i < n; ++i) {
+      co_await canal.send(i);
+   }
+   canal.close();
+}
+
+Task consommateur(Channel<T>& canal) {
+   while (optional<T> valeur = co_await canal.receive()) {
+      cout << "\nReçu " << *valeur << " ";
+   }
+}
+
 int main(int argc, const char * argv[]) {
 
    const int N = 9;
@@ -611,6 +232,77 @@ int main(int argc, const char * argv[]) {
    liste.sort();
    cout << "\nAprès: " << liste;
 
+   {
+      cout << "\n\nSuppression différée sur une copie de la liste\n";
+      LinkedList<T> copie = liste;
+      copie.set_lazy_erase(true);
+
+      cout << "\nSuppression des éléments en position 1 et 3 (marqués seulement)";
+      copie.erase(1);
+      copie.erase(3);
+      cout << "\nCopie - " << copie;
+
+      cout << "\nSuppression des éléments inférieurs à 45\n";
+      copie.erase_if([](T& i) { return i < 45; });
+      cout << "\nCopie - " << copie;
+
+      cout << "\nAffectation de la copie à une autre liste\n";
+      LinkedList<T> autre;
+      autre = copie;
+      cout << "\nAutre - " << autre;
+
+      cout << "\nSuppression en tête\n";
+      copie.pop_front();
+      cout << "\nCopie - " << copie;
+
+      cout << "\nLibération des maillons supprimés\n";
+      copie.compact();
+      cout << "\nCopie - " << copie;
+      cout << "\nDestruction des copies\n";
+   }
+
+   {
+      cout << "\n\nListe compacte, à liens de 32 bits\n";
+      LinkedList<T, true> compacte;
+      for (int i = 0; i < 5; ++i)
+         compacte.push_back(10 * (5 - i));
+      cout << "\nCompacte - " << compacte;
+
+      cout << "\nInsertion de l'élément 15 en position 2\n";
+      compacte.insert(15, 2);
+      cout << "\nCompacte - " << compacte;
+
+      cout << "\nSuppression de l'élément en position 0\n";
+      compacte.erase(0);
+      cout << "\nCompacte - " << compacte;
+
+      try {
+         cout << "\nMise à -2 de l'élément en position 1 puis copie de la liste\n";
+         compacte.at(1) = -2;
+         LinkedList<T, true> copie = compacte;
+         cout << "\nException non levée";
+      } catch (...) {
+         cout << "\nException capturée \n";
+         compacte.at(1) = 35;
+      }
+
+      cout << "\nTri\n";
+      compacte.sort();
+      cout << "\nCompacte - ";
+      compacte.print(cout);
+      cout << "\nDestruction de la liste compacte\n";
+   }
+
+   {
+      cout << "\n\nCanal de capacité 2 entre deux coroutines\n";
+      InlineExecutor executor;
+      Channel<T> canal(executor, 2);
+      executor.spawn(producteur(canal, 4));
+      executor.spawn(consommateur(canal));
+      executor.run();
+      cout << "\nFin des coroutines\n";
+   }
+
    cout << "\nDestruction liste \n";
 
    return EXIT_SUCCESS;